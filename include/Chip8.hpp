@@ -10,12 +10,21 @@
 #include "Constants.hpp"
         // Contains all the constants related to the Chip-8 Interpreter
 
+class Chip8Debugger;
+class Chip8Fuzzer;
+
 class Chip8 {
+        friend class Chip8Debugger;
+        friend class Chip8Fuzzer;
+
 public:
         Chip8() = delete;
         Chip8(std::string_view filePath);
         ~Chip8() = default;
 
+        // The current frame, one 64-bit row per scanline
+        const std::array<uint64_t, SCREEN_HEIGHT>& GetDisplayBuffer() const;
+
 private:
         // Clear the display
         void op_00e0();
@@ -131,6 +140,9 @@ private:
         void call_corresponding_function_for_opcode_starting_with_8();
         void call_corresponding_function_for_opcode_starting_with_f();
 
+        // Patched into the dispatch table by an attached debugger in place of an opcode group
+        void op_debug_trap();
+
         // Helper Functions
         void InitializeMemory();
         void LoadFonts();
@@ -165,6 +177,10 @@ private:
         static const std::unordered_map<uint8_t, Chip8_Opcode_Function_Ptr> function_ptrs_starting_with_8;
         
         static const std::array<uint8_t, FONTSET_SIZE> fontset;
+
+        // Per-instance copy of function_ptrs that a debugger can patch trap entries into
+        std::array<Chip8_Opcode_Function_Ptr, NUMBER_OF_OPCODE_GROUPS> dispatch_table;
+        Chip8Debugger* attached_debugger;
 };
 
 #endif
@@ -0,0 +1,107 @@
+#ifndef CHIP8_DEBUGGER_HPP
+#define CHIP8_DEBUGGER_HPP
+
+#include <cstdint>
+        // The cstdint header file holds the required definitions for portable typedefs
+#include <bitset>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Chip8.hpp"
+        // The interpreter being debugged
+#include "Constants.hpp"
+        // Contains all the constants related to the Chip-8 Interpreter
+
+// The debugger never checks a breakpoint list on every instruction. Instead it patches
+// Chip8::op_debug_trap into the dispatch table entries of only those opcode groups that can hit a
+// breakpoint or watchpoint, so every other instruction runs through the original function pointer.
+class Chip8Debugger {
+        friend class Chip8;
+
+public:
+        enum class StopReason {
+                None,
+                Breakpoint,
+                MemoryWatchpoint,
+                IndexRegisterWatchpoint,
+                StepComplete,
+                CycleLimit
+        };
+
+        // A breakpoint with a condition only stops when register x holds the given value
+        struct RegisterCondition {
+                uint8_t register_number;
+                uint8_t value;
+        };
+
+        Chip8Debugger() = delete;
+        Chip8Debugger(Chip8& chip8);
+        Chip8Debugger(const Chip8Debugger&) = delete;
+        Chip8Debugger& operator=(const Chip8Debugger&) = delete;
+        ~Chip8Debugger();
+
+        // Stop before the instruction at the given address is executed
+        void AddBreakpoint(uint16_t address);
+
+        // Stop before the instruction at the given address is executed, if the condition holds
+        void AddConditionalBreakpoint(uint16_t address, RegisterCondition condition);
+
+        void RemoveBreakpoint(uint16_t address);
+
+        // Stop after an op_fx33, op_fx55 or op_fx65 touches memory between the two addresses (inclusive)
+        void AddMemoryWatchpoint(uint16_t first_address, uint16_t last_address);
+
+        void RemoveMemoryWatchpoint(uint16_t first_address, uint16_t last_address);
+
+        // Stop after any instruction that changes the index register
+        void WatchIndexRegister(bool enabled);
+
+        // Execute exactly one instruction, stepping past the breakpoint the debugger last stopped on.
+        // Landing on a breakpoint is reported as a Breakpoint stop.
+        StopReason Step();
+
+        // Like Step, except that a 2nnn call runs until its subroutine returns to the next instruction
+        StopReason StepOver(uint64_t maximum_cycles);
+
+        // Run until a breakpoint or watchpoint is hit, or the cycle limit is reached
+        StopReason Continue(uint64_t maximum_cycles);
+
+        StopReason GetStopReason() const;
+
+        // The address of the instruction that caused the last stop
+        uint16_t GetStopAddress() const;
+
+private:
+        // Called through Chip8::op_debug_trap for every instruction in a patched opcode group
+        void HandleTrap();
+
+        void PatchDispatchTable();
+        void TrapOpcodeGroupAt(uint16_t address);
+        bool IsBreakpointHit(uint16_t address) const;
+        bool IsMemoryWatched(uint16_t first_address, uint16_t last_address) const;
+        void Stop(StopReason reason, uint16_t address);
+        StopReason Run(uint64_t maximum_cycles);
+
+private:
+        Chip8& chip8;
+
+        std::unordered_map<uint16_t, std::optional<RegisterCondition>> breakpoints;
+        std::vector<std::pair<uint16_t, uint16_t>> memory_watchpoints;
+        bool index_register_watched;
+
+        // Return address and stack depth that end a StepOver
+        std::optional<std::pair<uint16_t, uint8_t>> step_over_target;
+
+        // Addresses whose opcode group is trapped, for spotting stores that rewrite them
+        std::bitset<MEMORY_SIZE> trapped_addresses;
+
+        // Address whose breakpoint is ignored for the first cycle after resuming from it
+        std::optional<uint16_t> resume_address;
+
+        StopReason stop_reason;
+        uint16_t stop_address;
+};
+
+#endif
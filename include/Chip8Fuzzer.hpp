@@ -0,0 +1,119 @@
+#ifndef CHIP8_FUZZER_HPP
+#define CHIP8_FUZZER_HPP
+
+#include <cstdint>
+        // The cstdint header file holds the required definitions for portable typedefs
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Chip8.hpp"
+        // The interpreter being fuzzed
+#include "Constants.hpp"
+        // Contains all the constants related to the Chip-8 Interpreter
+
+// Coverage-guided fuzzer that mutates ROM bytes together with a sequence of keypad states. Coverage
+// is the set of (previous program counter, program counter) edges taken by the instruction cycle.
+// Every execution restores a pristine Chip8 by copy assignment instead of constructing a new one,
+// and worker threads share one corpus and one coverage map.
+class Chip8Fuzzer {
+public:
+        struct TestCase {
+                std::vector<uint8_t> rom;
+                std::vector<uint16_t> keypad_states;    // One state per CYCLES_PER_KEYPAD_STATE cycles
+        };
+
+        enum class FaultKind {
+                None,
+                ProgramCounterOutOfBounds,
+                StackOverflow,                  // op_2nnn with a full stack
+                StackUnderflow,                 // op_00ee with an empty stack
+                ReturnAddressMismatch,          // op_00ee did not return to the address on the stack
+                MemoryOutOfBounds,              // op_fx33, op_fx55, op_fx65 or op_dxyn past the end of memory
+                UncaughtException               // Anything thrown by the instruction cycle itself
+        };
+
+        struct Finding {
+                FaultKind kind;
+                uint16_t address;
+                uint16_t instruction;
+                TestCase test_case;
+        };
+
+        Chip8Fuzzer() = delete;
+        Chip8Fuzzer(const std::vector<TestCase>& seeds, uint32_t cyclesPerExecution);
+        Chip8Fuzzer(const Chip8Fuzzer&) = delete;
+        Chip8Fuzzer& operator=(const Chip8Fuzzer&) = delete;
+        ~Chip8Fuzzer() = default;
+
+        // Fuzz on the given number of threads until the duration has passed
+        void Run(unsigned workerCount, std::chrono::seconds duration);
+
+        // Execute a single test case, returning the first fault it hits
+        Finding Execute(const TestCase& test_case);
+
+        std::vector<Finding> GetFindings();
+        uint64_t GetExecutions() const;
+        uint32_t GetCoveredEdges() const;
+        size_t GetCorpusSize();
+
+        static const char* FaultKindName(FaultKind kind);
+
+private:
+        // Edges are hashed into 2^20 slots, a 1 MiB shared map and a 4 MiB generation map per worker.
+        // That is sparse enough to keep collisions rare among the at most 2^24 12-bit program counter pairs.
+        static const uint32_t COVERAGE_MAP_BITS = 20u;
+        static const uint32_t COVERAGE_MAP_SIZE = 1u << COVERAGE_MAP_BITS;
+        static const uint32_t CYCLES_PER_KEYPAD_STATE = 16u;
+        static const uint32_t EXECUTIONS_PER_CORPUS_SYNC = 1024u;
+
+        // At most 4096 entries of up to 3.5 KiB each, shared by every worker
+        static const size_t MAXIMUM_CORPUS_SIZE = 4096u;
+
+        // State that each worker thread owns so that executions never contend on a lock
+        struct Worker {
+                Worker(const Chip8& pristine_chip8, uint64_t seed);
+
+                Chip8 chip8;
+                uint64_t random_state;
+                std::vector<uint32_t> edge_generation;  // Generation each edge was last seen in
+                uint32_t generation;
+                std::vector<uint32_t> edges;            // Edges seen in the current execution
+                std::vector<std::shared_ptr<const TestCase>> corpus;    // Snapshot of the shared corpus
+                uint64_t corpus_version;                                // Version the snapshot was taken at
+
+                uint64_t NextRandom();
+        };
+
+        void WorkerLoop(unsigned worker_index, std::chrono::steady_clock::time_point deadline);
+        Finding Execute(Worker& worker, const TestCase& test_case);
+        FaultKind CheckInstruction(const Chip8& chip8) const;
+        void Mutate(Worker& worker, TestCase& test_case) const;
+        bool MergeCoverage(const Worker& worker);
+        void SyncCorpus(Worker& worker);
+        void AddToCorpus(Worker& worker, const TestCase& test_case);
+        void RecordFinding(const Finding& finding);
+
+private:
+        const Chip8 pristine_chip8;
+        const uint32_t cycles_per_execution;
+
+        std::unique_ptr<std::atomic<uint8_t>[]> coverage_map;
+        std::atomic<uint32_t> covered_edges;
+        std::atomic<uint64_t> executions;
+
+        std::mutex corpus_mutex;
+        std::vector<std::shared_ptr<const TestCase>> corpus;
+        size_t seed_count;                      // Seeds sit at the front and are never evicted
+        uint64_t corpus_version;                // Bumped on every change to the corpus
+
+        std::mutex findings_mutex;
+        std::vector<Finding> findings;
+        std::set<std::pair<FaultKind, uint16_t>> finding_sites;     // Fault kind and opcode pattern
+};
+
+#endif
@@ -6,7 +6,7 @@
 
 // Size Constants
 const uint8_t NUMBER_OF_REGISTERS = 16u;
-const uint8_t MEMORY_SIZE = 4096u;
+const uint16_t MEMORY_SIZE = 4096u;
 const uint8_t SCREEN_WIDTH = 64u;
 const uint8_t SCREEN_HEIGHT = 32u;
 const uint8_t STACK_SIZE = 64u;
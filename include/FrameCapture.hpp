@@ -0,0 +1,85 @@
+#ifndef FRAME_CAPTURE_HPP
+#define FRAME_CAPTURE_HPP
+
+#include <cstdint>
+        // The cstdint header file holds the required definitions for portable typedefs
+#include <array>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Constants.hpp"
+        // Contains all the constants related to the Chip-8 Interpreter
+
+// Streams successive display buffers to an animated GIF and to a raw run-length encoded container.
+// Pixel x of a row is bit (63 - x), matching the layout of Chip8::display_buffer.
+//
+// The RLE container starts with the bytes "BSRL", a version byte and the screen width and height.
+// Each record is a varint holding how many 60 Hz frames the image stays on screen, followed by the
+// XOR of the image with the previous record as alternating runs of 0 and 1 bits (varints, starting
+// with a run of 0 bits) covering all SCREEN_WIDTH * SCREEN_HEIGHT bits. A hold count of 0 ends the stream.
+class FrameCapture {
+public:
+        typedef std::array<uint64_t, SCREEN_HEIGHT> Frame;
+
+        FrameCapture() = delete;
+        FrameCapture(std::string_view gifFilePath, std::string_view rleFilePath, uint8_t gifScale = 1u);
+        FrameCapture(const FrameCapture&) = delete;
+        FrameCapture& operator=(const FrameCapture&) = delete;
+        ~FrameCapture();
+
+        // Submit the display buffer once per 60 Hz frame. Duplicate frames only extend the hold count
+        // of the previous frame, and encoding happens on a background thread.
+        void SubmitFrame(const Frame& frame);
+
+        // Flush the last frame, wait for the encoder and close both files
+        void Finish();
+
+private:
+        // A distinct frame together with the number of 60 Hz frames it was held for
+        typedef std::pair<Frame, uint32_t> HeldFrame;
+
+        void EncoderLoop();
+        void EncodeGifFrame(const Frame& frame, uint32_t held_frames);
+        void EncodeRleFrame(const Frame& frame, uint32_t held_frames);
+
+        void WriteGifHeader();
+        void WriteGifImage(const Frame& frame, uint16_t delay);
+        void WriteRleHeader();
+        void WriteRleVarint(uint32_t value);
+
+private:
+        std::ofstream gif_file;
+        std::ofstream rle_file;
+        uint8_t gif_scale;
+
+        // Producer side, only touched by the emulator thread
+        Frame held_frame;
+        uint32_t held_frames;
+        bool finished;
+
+        // Shared between the emulator thread and the encoder thread
+        std::mutex queue_mutex;
+        std::condition_variable queue_condition;
+        std::vector<HeldFrame> pending_frames;
+        bool stopping;
+
+        // Encoder side, only touched by the encoder thread
+        Frame previous_gif_frame;
+        Frame previous_rle_frame;
+        uint64_t gif_frames_encoded;
+        uint64_t gif_centiseconds_encoded;
+        Frame deferred_gif_frame;
+        bool gif_frame_deferred;
+        bool gif_image_written;
+        std::vector<uint8_t> gif_bytes;
+        std::vector<uint8_t> rle_bytes;
+
+        std::thread encoder_thread;
+};
+
+#endif
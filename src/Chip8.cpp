@@ -2,7 +2,10 @@
         // For Header Definitions
 #include "Constants.hpp"
         // For Required Constants
+#include "Chip8Debugger.hpp"
+        // For forwarding trapped instructions to an attached debugger
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <fstream>
@@ -19,7 +22,9 @@ Chip8::Chip8(std::string_view filePath)
         instruction(0u),
         delay_timer(0u),
         sound_timer(0u),
-        keypad(0u) 
+        keypad(0u),
+        dispatch_table(function_ptrs),
+        attached_debugger(nullptr)
 {
         InitializeMemory();
         LoadFonts();
@@ -50,8 +55,9 @@ Chip8::LoadRom(std::string_view filePath)
 	if (file.is_open())
 	{
 		// Get size of file and allocate a buffer to hold the contents
-		std::streampos size = file.tellg();
-		std::vector<char> buffer_vector;
+		// Anything past the end of memory is dropped
+		const size_t size = std::min<size_t>(static_cast<size_t>(file.tellg()), MEMORY_SIZE - MEMORY_START_ADDRESS);
+		std::vector<char> buffer_vector(size);
 
 		// Go back to the beginning of the file and fill the buffer
 		file.seekg(0, std::ios::beg);
@@ -62,6 +68,29 @@ Chip8::LoadRom(std::string_view filePath)
 	}
 }
 
+const std::array<uint64_t, SCREEN_HEIGHT>&
+Chip8::GetDisplayBuffer() const
+{
+        return display_buffer;
+}
+
+void
+Chip8::InstructionCycle()
+{
+        // Instructions are stored big-endian. The program counter is moved past the instruction
+        // before it is executed, so jumps and skips can simply overwrite or add to it.
+        instruction = static_cast<uint16_t>((memory.at(program_counter) << 8u) | memory.at(program_counter + 1));
+        program_counter += 2;
+
+        (this->*dispatch_table[(instruction & 0xF000u) >> 12u])();
+}
+
+void
+Chip8::op_debug_trap()
+{
+        attached_debugger->HandleTrap();
+}
+
 void
 Chip8::call_corresponding_function_for_opcode_starting_with_0()
 {
@@ -71,13 +100,13 @@ Chip8::call_corresponding_function_for_opcode_starting_with_0()
 void
 Chip8::call_corresponding_function_for_opcode_starting_with_e()
 {
-        (this->*function_ptrs_starting_with_8.at(instruction & 0x000Fu))();
+        (this->*function_ptrs_starting_with_e.at(instruction & 0x00FFu))();
 }
 
 void
 Chip8::call_corresponding_function_for_opcode_starting_with_8()
 {
-        (this->*function_ptrs_starting_with_e.at(instruction & 0x00FFu))();
+        (this->*function_ptrs_starting_with_8.at(instruction & 0x000Fu))();
 }
 
 void
@@ -140,7 +169,7 @@ const std::unordered_map<uint8_t, Chip8_Opcode_Function_Ptr> Chip8::function_ptr
         std::pair<uint8_t, Chip8_Opcode_Function_Ptr>(0x65, &Chip8::op_fx65), 
 };
 
-const std::array<uint8_t, FONTSET_SIZE> fontset = {
+const std::array<uint8_t, FONTSET_SIZE> Chip8::fontset = {
 	0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
 	0x20, 0x60, 0x20, 0x20, 0x70, // 1
 	0xF0, 0x10, 0xF0, 0x80, 0xF0, // 2
@@ -0,0 +1,265 @@
+#include "Chip8Debugger.hpp"
+        // For Header Definitions
+#include "Chip8.hpp"
+        // For the interpreter internals being patched
+#include "Constants.hpp"
+        // For Required Constants
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+Chip8Debugger::Chip8Debugger(Chip8& chip8)
+        :
+        chip8(chip8),
+        index_register_watched(false),
+        stop_reason(StopReason::None),
+        stop_address(0u)
+{
+        chip8.attached_debugger = this;
+}
+
+Chip8Debugger::~Chip8Debugger()
+{
+        // Detaching puts every instruction back on the original function pointers
+        chip8.dispatch_table = Chip8::function_ptrs;
+        chip8.attached_debugger = nullptr;
+}
+
+void
+Chip8Debugger::AddBreakpoint(uint16_t address)
+{
+        breakpoints[address] = std::nullopt;
+        PatchDispatchTable();
+}
+
+void
+Chip8Debugger::AddConditionalBreakpoint(uint16_t address, RegisterCondition condition)
+{
+        breakpoints[address] = condition;
+        PatchDispatchTable();
+}
+
+void
+Chip8Debugger::RemoveBreakpoint(uint16_t address)
+{
+        breakpoints.erase(address);
+        PatchDispatchTable();
+}
+
+void
+Chip8Debugger::AddMemoryWatchpoint(uint16_t first_address, uint16_t last_address)
+{
+        memory_watchpoints.emplace_back(first_address, last_address);
+        PatchDispatchTable();
+}
+
+void
+Chip8Debugger::RemoveMemoryWatchpoint(uint16_t first_address, uint16_t last_address)
+{
+        const std::pair<uint16_t, uint16_t> watchpoint(first_address, last_address);
+        memory_watchpoints.erase(
+                std::remove(memory_watchpoints.begin(), memory_watchpoints.end(), watchpoint),
+                memory_watchpoints.end());
+        PatchDispatchTable();
+}
+
+void
+Chip8Debugger::WatchIndexRegister(bool enabled)
+{
+        index_register_watched = enabled;
+        PatchDispatchTable();
+}
+
+Chip8Debugger::StopReason
+Chip8Debugger::Step()
+{
+        Run(1u);
+
+        // Landing on a breakpoint reports it now, so the next step runs the instruction under it
+        if (stop_reason == StopReason::CycleLimit)
+                Stop(IsBreakpointHit(chip8.program_counter) ? StopReason::Breakpoint : StopReason::StepComplete,
+                     chip8.program_counter);
+
+        return stop_reason;
+}
+
+Chip8Debugger::StopReason
+Chip8Debugger::StepOver(uint64_t maximum_cycles)
+{
+        const uint16_t call_instruction = static_cast<uint16_t>(
+                (chip8.memory.at(chip8.program_counter) << 8u) | chip8.memory.at(chip8.program_counter + 1));
+
+        if ((call_instruction & 0xF000u) != 0x2000u)
+                return Step();
+
+        // The subroutine has returned once the instruction after the call is reached at the same
+        // stack depth, which keeps recursive calls from ending the step early
+        step_over_target = std::make_pair(static_cast<uint16_t>(chip8.program_counter + 2), chip8.stack_pointer);
+        PatchDispatchTable();
+
+        Run(maximum_cycles);
+
+        step_over_target.reset();
+        PatchDispatchTable();
+
+        if (stop_reason == StopReason::StepComplete && IsBreakpointHit(chip8.program_counter))
+                Stop(StopReason::Breakpoint, chip8.program_counter);
+
+        return stop_reason;
+}
+
+Chip8Debugger::StopReason
+Chip8Debugger::Continue(uint64_t maximum_cycles)
+{
+        return Run(maximum_cycles);
+}
+
+Chip8Debugger::StopReason
+Chip8Debugger::GetStopReason() const
+{
+        return stop_reason;
+}
+
+uint16_t
+Chip8Debugger::GetStopAddress() const
+{
+        return stop_address;
+}
+
+Chip8Debugger::StopReason
+Chip8Debugger::Run(uint64_t maximum_cycles)
+{
+        // Resuming from a breakpoint must execute the instruction it stopped on. Any other stop
+        // leaves the program counter on an instruction that has not been checked yet.
+        const bool resuming_from_breakpoint = stop_reason == StopReason::Breakpoint
+                                              && stop_address == chip8.program_counter;
+        if (resuming_from_breakpoint)
+                resume_address = chip8.program_counter;
+
+        stop_reason = StopReason::None;
+
+        for (uint64_t cycle = 0; cycle < maximum_cycles && stop_reason == StopReason::None; ++cycle) {
+                chip8.InstructionCycle();
+                resume_address.reset();
+        }
+
+        if (stop_reason == StopReason::None)
+                Stop(StopReason::CycleLimit, chip8.program_counter);
+
+        return stop_reason;
+}
+
+void
+Chip8Debugger::HandleTrap()
+{
+        // The program counter has already been moved past the trapped instruction
+        const uint16_t instruction_address = chip8.program_counter - 2;
+        const uint8_t opcode_group = static_cast<uint8_t>((chip8.instruction & 0xF000u) >> 12u);
+        const uint8_t register_number = static_cast<uint8_t>((chip8.instruction & 0x0F00u) >> 8u);
+        const uint8_t low_byte = static_cast<uint8_t>(chip8.instruction & 0x00FFu);
+
+        if (instruction_address != resume_address) {
+                if (step_over_target && step_over_target->first == instruction_address
+                    && step_over_target->second == chip8.stack_pointer) {
+                        chip8.program_counter = instruction_address;
+                        Stop(StopReason::StepComplete, instruction_address);
+                        return;
+                }
+
+                if (IsBreakpointHit(instruction_address)) {
+                        chip8.program_counter = instruction_address;
+                        Stop(StopReason::Breakpoint, instruction_address);
+                        return;
+                }
+        }
+
+        // Work out which memory the instruction touches before it moves the index register
+        uint16_t bytes_touched = 0u;
+        if (opcode_group == 0xFu) {
+                if (low_byte == 0x33u)
+                        bytes_touched = 3u;
+                else if (low_byte == 0x55u || low_byte == 0x65u)
+                        bytes_touched = register_number + 1u;
+        }
+
+        const uint16_t index_register_before = chip8.index_register;
+
+        (chip8.*Chip8::function_ptrs[opcode_group])();
+
+        if (bytes_touched != 0u
+            && IsMemoryWatched(index_register_before, index_register_before + bytes_touched - 1u))
+                Stop(StopReason::MemoryWatchpoint, instruction_address);
+        else if (index_register_watched && chip8.index_register != index_register_before)
+                Stop(StopReason::IndexRegisterWatchpoint, instruction_address);
+
+        // Self-modifying code can change the opcode group that sits under a breakpoint. The group is
+        // in the first byte of an instruction, so only a store over a trapped address matters.
+        if (bytes_touched != 0u && low_byte != 0x65u) {
+                for (uint32_t address = index_register_before;
+                     address < index_register_before + bytes_touched && address < MEMORY_SIZE; ++address) {
+                        if (trapped_addresses[address]) {
+                                PatchDispatchTable();
+                                break;
+                        }
+                }
+        }
+}
+
+void
+Chip8Debugger::PatchDispatchTable()
+{
+        chip8.dispatch_table = Chip8::function_ptrs;
+        trapped_addresses.reset();
+
+        for (const auto& breakpoint : breakpoints)
+                TrapOpcodeGroupAt(breakpoint.first);
+
+        if (step_over_target)
+                TrapOpcodeGroupAt(step_over_target->first);
+
+        // The watched memory accesses all live in the 0xF group, which also holds every index register
+        // write except op_annn
+        if (!breakpoints.empty() || !memory_watchpoints.empty() || index_register_watched)
+                chip8.dispatch_table[0xFu] = &Chip8::op_debug_trap;
+
+        if (index_register_watched)
+                chip8.dispatch_table[0xAu] = &Chip8::op_debug_trap;
+}
+
+void
+Chip8Debugger::TrapOpcodeGroupAt(uint16_t address)
+{
+        const uint8_t opcode_group = static_cast<uint8_t>((chip8.memory.at(address) & 0xF0u) >> 4u);
+        chip8.dispatch_table[opcode_group] = &Chip8::op_debug_trap;
+        trapped_addresses.set(address);
+}
+
+bool
+Chip8Debugger::IsBreakpointHit(uint16_t address) const
+{
+        const auto breakpoint = breakpoints.find(address);
+        if (breakpoint == breakpoints.end())
+                return false;
+
+        const std::optional<RegisterCondition>& condition = breakpoint->second;
+        return !condition || chip8.registers.at(condition->register_number) == condition->value;
+}
+
+bool
+Chip8Debugger::IsMemoryWatched(uint16_t first_address, uint16_t last_address) const
+{
+        for (const auto& watchpoint : memory_watchpoints)
+                if (first_address <= watchpoint.second && watchpoint.first <= last_address)
+                        return true;
+
+        return false;
+}
+
+void
+Chip8Debugger::Stop(StopReason reason, uint16_t address)
+{
+        stop_reason = reason;
+        stop_address = address;
+}
@@ -0,0 +1,422 @@
+#include "Chip8Fuzzer.hpp"
+        // For Header Definitions
+#include "Chip8.hpp"
+        // For the interpreter internals being checked
+#include "Constants.hpp"
+        // For Required Constants
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+Chip8Fuzzer::Worker::Worker(const Chip8& pristine_chip8, uint64_t seed)
+        :
+        chip8(pristine_chip8),
+        random_state(seed | 1u),
+        edge_generation(COVERAGE_MAP_SIZE, 0u),
+        generation(0u),
+        corpus_version(UINT64_MAX)
+{
+}
+
+uint64_t
+Chip8Fuzzer::Worker::NextRandom()
+{
+        // xorshift64*, which is plenty for choosing mutations and far cheaper than std::mt19937_64
+        random_state ^= random_state >> 12u;
+        random_state ^= random_state << 25u;
+        random_state ^= random_state >> 27u;
+        return random_state * 0x2545F4914F6CDD1Dull;
+}
+
+Chip8Fuzzer::Chip8Fuzzer(const std::vector<TestCase>& seeds, uint32_t cyclesPerExecution)
+        :
+        // There is no ROM file to load; every execution copies its ROM bytes into memory directly
+        pristine_chip8(""),
+        cycles_per_execution(cyclesPerExecution),
+        coverage_map(new std::atomic<uint8_t>[COVERAGE_MAP_SIZE]()),
+        covered_edges(0u),
+        executions(0u),
+        corpus_version(0u)
+{
+        // Mutations assume every ROM fits in memory after MEMORY_START_ADDRESS
+        for (TestCase seed : seeds) {
+                seed.rom.resize(std::min<size_t>(seed.rom.size(), MEMORY_SIZE - MEMORY_START_ADDRESS));
+                corpus.push_back(std::make_shared<const TestCase>(std::move(seed)));
+        }
+
+        if (corpus.empty())
+                corpus.push_back(std::make_shared<const TestCase>());
+
+        seed_count = corpus.size();
+}
+
+void
+Chip8Fuzzer::Run(unsigned workerCount, std::chrono::seconds duration)
+{
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + duration;
+
+        std::vector<std::thread> workers;
+        for (unsigned i = 0; i < std::max(workerCount, 1u); ++i)
+                workers.emplace_back(&Chip8Fuzzer::WorkerLoop, this, i, deadline);
+
+        for (std::thread& worker : workers)
+                worker.join();
+}
+
+Chip8Fuzzer::Finding
+Chip8Fuzzer::Execute(const TestCase& test_case)
+{
+        Worker worker(pristine_chip8, 1u);
+
+        Finding finding = Execute(worker, test_case);
+        finding.test_case = test_case;
+        return finding;
+}
+
+std::vector<Chip8Fuzzer::Finding>
+Chip8Fuzzer::GetFindings()
+{
+        std::lock_guard<std::mutex> lock(findings_mutex);
+        return findings;
+}
+
+uint64_t
+Chip8Fuzzer::GetExecutions() const
+{
+        return executions.load();
+}
+
+uint32_t
+Chip8Fuzzer::GetCoveredEdges() const
+{
+        return covered_edges.load();
+}
+
+size_t
+Chip8Fuzzer::GetCorpusSize()
+{
+        std::lock_guard<std::mutex> lock(corpus_mutex);
+        return corpus.size();
+}
+
+const char*
+Chip8Fuzzer::FaultKindName(FaultKind kind)
+{
+        switch (kind) {
+        case FaultKind::None:                           return "none";
+        case FaultKind::ProgramCounterOutOfBounds:      return "program_counter_out_of_bounds";
+        case FaultKind::StackOverflow:                  return "stack_overflow";
+        case FaultKind::StackUnderflow:                 return "stack_underflow";
+        case FaultKind::ReturnAddressMismatch:          return "return_address_mismatch";
+        case FaultKind::MemoryOutOfBounds:              return "memory_out_of_bounds";
+        case FaultKind::UncaughtException:              return "uncaught_exception";
+        }
+
+        return "unknown";
+}
+
+void
+Chip8Fuzzer::WorkerLoop(unsigned worker_index, std::chrono::steady_clock::time_point deadline)
+{
+        Worker worker(pristine_chip8, 0x9E3779B97F4A7C15ull * (worker_index + 1u));
+        TestCase test_case;
+
+        for (uint64_t local_executions = 0;; ++local_executions) {
+                // Checking the clock and the shared corpus only every so often keeps workers lock-free
+                if (local_executions % EXECUTIONS_PER_CORPUS_SYNC == 0u) {
+                        executions.fetch_add(local_executions == 0u ? 0u : EXECUTIONS_PER_CORPUS_SYNC);
+                        SyncCorpus(worker);
+                        if (std::chrono::steady_clock::now() >= deadline)
+                                break;
+                }
+
+                test_case = *worker.corpus[worker.NextRandom() % worker.corpus.size()];
+                Mutate(worker, test_case);
+
+                Finding finding = Execute(worker, test_case);
+
+                if (MergeCoverage(worker))
+                        AddToCorpus(worker, test_case);
+
+                if (finding.kind != FaultKind::None) {
+                        finding.test_case = test_case;
+                        RecordFinding(finding);
+                }
+        }
+}
+
+Chip8Fuzzer::Finding
+Chip8Fuzzer::Execute(Worker& worker, const TestCase& test_case)
+{
+        Chip8& chip8 = worker.chip8;
+
+        // Restoring by copy assignment is a handful of memcpys, unlike constructing a new Chip8
+        chip8 = pristine_chip8;
+        const size_t rom_size = std::min<size_t>(test_case.rom.size(), MEMORY_SIZE - MEMORY_START_ADDRESS);
+        std::copy_n(test_case.rom.begin(), rom_size, chip8.memory.begin() + MEMORY_START_ADDRESS);
+
+        // Bumping the generation forgets the previous execution's edges without clearing the map
+        if (++worker.generation == 0u) {
+                std::fill(worker.edge_generation.begin(), worker.edge_generation.end(), 0u);
+                worker.generation = 1u;
+        }
+        worker.edges.clear();
+
+        uint16_t previous_program_counter = 0u;
+
+        for (uint32_t cycle = 0; cycle < cycles_per_execution; ++cycle) {
+                const uint32_t keypad_state = cycle / CYCLES_PER_KEYPAD_STATE;
+                if (cycle % CYCLES_PER_KEYPAD_STATE == 0u && keypad_state < test_case.keypad_states.size())
+                        chip8.keypad = test_case.keypad_states[keypad_state];
+
+                const uint16_t program_counter = chip8.program_counter;
+                // Multiply-shift hashing spreads every (previous, current) pair over the whole map, so
+                // nearby edges such as 0x202->0x220 and 0x200->0x200 land in different slots
+                const uint32_t edge_pair = (static_cast<uint32_t>(previous_program_counter) << 16u) | program_counter;
+                const uint32_t edge = (edge_pair * 0x9E3779B1u) >> (32u - COVERAGE_MAP_BITS);
+                if (worker.edge_generation[edge] != worker.generation) {
+                        worker.edge_generation[edge] = worker.generation;
+                        worker.edges.push_back(edge);
+                }
+                previous_program_counter = program_counter;
+
+                const FaultKind fault = CheckInstruction(chip8);
+                if (fault == FaultKind::ProgramCounterOutOfBounds)
+                        return Finding{fault, program_counter, 0u, {}};
+
+                const uint16_t instruction = static_cast<uint16_t>(
+                        (chip8.memory[program_counter] << 8u) | chip8.memory[program_counter + 1u]);
+                if (fault != FaultKind::None)
+                        return Finding{fault, program_counter, instruction, {}};
+
+                // op_00ee has to land on the address op_2nnn pushed, low byte first
+                const bool returning = instruction == 0x00EEu;
+                uint16_t return_address = 0u;
+                if (returning)
+                        return_address = static_cast<uint16_t>(chip8.stack[chip8.stack_pointer - 2u]
+                                                               | (chip8.stack[chip8.stack_pointer - 1u] << 8u));
+
+                try {
+                        chip8.InstructionCycle();
+                } catch (const std::exception&) {
+                        return Finding{FaultKind::UncaughtException, program_counter, instruction, {}};
+                }
+
+                if (returning && chip8.program_counter != return_address)
+                        return Finding{FaultKind::ReturnAddressMismatch, program_counter, instruction, {}};
+        }
+
+        return Finding{FaultKind::None, 0u, 0u, {}};
+}
+
+Chip8Fuzzer::FaultKind
+Chip8Fuzzer::CheckInstruction(const Chip8& chip8) const
+{
+        const uint16_t program_counter = chip8.program_counter;
+        if (program_counter + 1u >= MEMORY_SIZE)
+                return FaultKind::ProgramCounterOutOfBounds;
+
+        const uint16_t instruction = static_cast<uint16_t>(
+                (chip8.memory[program_counter] << 8u) | chip8.memory[program_counter + 1u]);
+        const uint8_t register_number = static_cast<uint8_t>((instruction & 0x0F00u) >> 8u);
+        const uint32_t index_register = chip8.index_register;
+
+        switch (instruction & 0xF000u) {
+        case 0x0000u:
+                if (instruction == 0x00EEu && chip8.stack_pointer < 2u)
+                        return FaultKind::StackUnderflow;
+                break;
+
+        case 0x2000u:
+                if (chip8.stack_pointer + 2u > STACK_SIZE)
+                        return FaultKind::StackOverflow;
+                break;
+
+        case 0xD000u:
+                if (index_register + (instruction & 0x000Fu) > MEMORY_SIZE)
+                        return FaultKind::MemoryOutOfBounds;
+                break;
+
+        case 0xF000u:
+                if ((instruction & 0x00FFu) == 0x33u && index_register + 3u > MEMORY_SIZE)
+                        return FaultKind::MemoryOutOfBounds;
+                if (((instruction & 0x00FFu) == 0x55u || (instruction & 0x00FFu) == 0x65u)
+                    && index_register + register_number + 1u > MEMORY_SIZE)
+                        return FaultKind::MemoryOutOfBounds;
+                break;
+        }
+
+        return FaultKind::None;
+}
+
+void
+Chip8Fuzzer::Mutate(Worker& worker, TestCase& test_case) const
+{
+        const size_t MAXIMUM_ROM_SIZE = MEMORY_SIZE - MEMORY_START_ADDRESS;
+        const size_t MAXIMUM_KEYPAD_STATES = cycles_per_execution / CYCLES_PER_KEYPAD_STATE + 1u;
+        const uint8_t NUMBER_OF_MUTATION_KINDS = 8u;
+        const uint8_t MAXIMUM_MUTATIONS = 8u;
+
+        std::vector<uint8_t>& rom = test_case.rom;
+        const uint32_t mutations = 1u + worker.NextRandom() % MAXIMUM_MUTATIONS;
+
+        for (uint32_t i = 0; i < mutations; ++i) {
+                // Instructions are two bytes wide and start on even addresses
+                const size_t instruction_offset = rom.size() < 2u ? 0u : (worker.NextRandom() % (rom.size() / 2u)) * 2u;
+
+                // Returns and clears are favoured because no random 16-bit value is likely to hit them
+                uint16_t instruction = static_cast<uint16_t>(worker.NextRandom());
+                if (worker.NextRandom() % 8u == 0u)
+                        instruction = worker.NextRandom() % 2u ? 0x00EEu : 0x00E0u;
+
+                switch (worker.NextRandom() % NUMBER_OF_MUTATION_KINDS) {
+                case 0u:
+                        if (!rom.empty())
+                                rom[worker.NextRandom() % rom.size()] ^= static_cast<uint8_t>(1u << (worker.NextRandom() % 8u));
+                        break;
+
+                case 1u:
+                        if (!rom.empty())
+                                rom[worker.NextRandom() % rom.size()] = static_cast<uint8_t>(worker.NextRandom());
+                        break;
+
+                case 2u:
+                        if (rom.size() < instruction_offset + 2u)
+                                rom.resize(instruction_offset + 2u);
+                        rom[instruction_offset] = static_cast<uint8_t>((instruction & 0xFF00u) >> 8u);
+                        rom[instruction_offset + 1u] = static_cast<uint8_t>(instruction & 0x00FFu);
+                        break;
+
+                case 3u:
+                        if (rom.size() + 2u <= MAXIMUM_ROM_SIZE)
+                                rom.insert(rom.begin() + instruction_offset,
+                                           { static_cast<uint8_t>((instruction & 0xFF00u) >> 8u),
+                                             static_cast<uint8_t>(instruction & 0x00FFu) });
+                        break;
+
+                case 4u:
+                        if (rom.size() >= 2u)
+                                rom.erase(rom.begin() + instruction_offset, rom.begin() + instruction_offset + 2u);
+                        break;
+
+                case 5u: {
+                        // Released and single keys are favoured, but any combination of keys can be held
+                        uint16_t keypad = static_cast<uint16_t>(worker.NextRandom());
+                        const uint64_t keypad_kind = worker.NextRandom() % 4u;
+                        if (keypad_kind == 0u)
+                                keypad = 0u;
+                        else if (keypad_kind == 1u)
+                                keypad = static_cast<uint16_t>(1u << (worker.NextRandom() % NUMBER_OF_KEYS));
+
+                        std::vector<uint16_t>& keypad_states = test_case.keypad_states;
+                        if (keypad_states.empty() || (keypad_states.size() < MAXIMUM_KEYPAD_STATES && worker.NextRandom() % 2u))
+                                keypad_states.push_back(keypad);
+                        else
+                                keypad_states[worker.NextRandom() % keypad_states.size()] = keypad;
+                        break;
+                }
+
+                case 7u: {
+                        // Erasing or duplicating a state shifts every later press and release in time
+                        std::vector<uint16_t>& keypad_states = test_case.keypad_states;
+                        if (keypad_states.empty())
+                                break;
+
+                        const size_t state = worker.NextRandom() % keypad_states.size();
+                        if (keypad_states.size() < MAXIMUM_KEYPAD_STATES && worker.NextRandom() % 2u)
+                                keypad_states.insert(keypad_states.begin() + state, keypad_states[state]);
+                        else
+                                keypad_states.erase(keypad_states.begin() + state);
+                        break;
+                }
+
+                case 6u: {
+                        // Splice a run of another corpus entry over this ROM
+                        const std::vector<uint8_t>& other = worker.corpus[worker.NextRandom() % worker.corpus.size()]->rom;
+                        if (other.empty())
+                                break;
+
+                        const size_t source = worker.NextRandom() % other.size();
+                        const size_t length = 1u + worker.NextRandom() % std::min(other.size() - source, MAXIMUM_ROM_SIZE);
+                        const size_t destination = std::min(instruction_offset, MAXIMUM_ROM_SIZE - length);
+                        if (rom.size() < destination + length)
+                                rom.resize(destination + length);
+                        std::copy_n(other.begin() + source, length, rom.begin() + destination);
+                        break;
+                }
+                }
+        }
+}
+
+bool
+Chip8Fuzzer::MergeCoverage(const Worker& worker)
+{
+        bool new_coverage = false;
+
+        for (const uint32_t edge : worker.edges) {
+                // The plain load keeps already covered edges from bouncing the cache line between cores
+                if (coverage_map[edge].load(std::memory_order_relaxed) == 0u
+                    && coverage_map[edge].exchange(1u, std::memory_order_relaxed) == 0u) {
+                        covered_edges.fetch_add(1u, std::memory_order_relaxed);
+                        new_coverage = true;
+                }
+        }
+
+        return new_coverage;
+}
+
+void
+Chip8Fuzzer::SyncCorpus(Worker& worker)
+{
+        // Entries are immutable, so workers share them and only copy the pointers when the corpus changed
+        std::lock_guard<std::mutex> lock(corpus_mutex);
+        if (worker.corpus_version != corpus_version) {
+                worker.corpus = corpus;
+                worker.corpus_version = corpus_version;
+        }
+}
+
+void
+Chip8Fuzzer::AddToCorpus(Worker& worker, const TestCase& test_case)
+{
+        std::shared_ptr<const TestCase> entry = std::make_shared<const TestCase>(test_case);
+
+        // A full corpus evicts a random entry other than the seeds, which keeps memory bounded once
+        // random jump targets keep turning up new edges
+        std::lock_guard<std::mutex> lock(corpus_mutex);
+        if (corpus.size() < MAXIMUM_CORPUS_SIZE || corpus.size() == seed_count)
+                corpus.push_back(std::move(entry));
+        else
+                corpus[seed_count + worker.NextRandom() % (corpus.size() - seed_count)] = std::move(entry);
+        ++corpus_version;
+}
+
+void
+Chip8Fuzzer::RecordFinding(const Finding& finding)
+{
+        std::lock_guard<std::mutex> lock(findings_mutex);
+
+        // Faults come from the opcode handlers rather than the ROM, so only the first test case to hit
+        // a fault in each handler is kept. Exceptions are mostly undefined opcodes, which are only
+        // told apart by their group.
+        uint16_t opcode_pattern = finding.instruction & 0xF000u;
+        if (finding.kind != FaultKind::UncaughtException) {
+                if (finding.instruction == 0x00E0u || finding.instruction == 0x00EEu)
+                        opcode_pattern = finding.instruction;
+                else if (opcode_pattern == 0x8000u)
+                        opcode_pattern = finding.instruction & 0xF00Fu;
+                else if (opcode_pattern == 0xE000u || opcode_pattern == 0xF000u)
+                        opcode_pattern = finding.instruction & 0xF0FFu;
+        }
+
+        if (finding_sites.emplace(finding.kind, opcode_pattern).second)
+                findings.push_back(finding);
+}
@@ -18,7 +18,8 @@ Chip8::op_00ee()
 {
         // The stack pointer stores the current available position
         stack_pointer = stack_pointer - 2 < 0 ? 0 : stack_pointer - 2;
-        program_counter = stack.at(stack_pointer) + stack.at(stack_pointer + 1) << 8;
+        // op_2nnn pushes the low byte first
+        program_counter = stack.at(stack_pointer) | (stack.at(stack_pointer + 1) << 8);
 }
 
 void
@@ -205,9 +206,10 @@ Chip8::op_cxkk()
         const uint8_t register_number = static_cast<uint8_t>((instruction & 0x0F00u) >> 8u);
         const uint8_t bytes = static_cast<uint8_t>((instruction & 0x00FFu));
 
-        const std::mt19937 mt{std::random_device{}()};
-        std::uniform_int_distribution<uint8_t> dist{0, 255};
-        const uint8_t random_byte = dist(mt);
+        // Seeding once per thread keeps a random_device read off every instruction
+        thread_local std::mt19937 mt{std::random_device{}()};
+        std::uniform_int_distribution<uint16_t> dist{0, 255};
+        const uint8_t random_byte = static_cast<uint8_t>(dist(mt));
 
         registers.at(register_number) = random_byte & bytes;
 }
@@ -0,0 +1,416 @@
+#include "FrameCapture.hpp"
+        // For Header Definitions
+#include "Constants.hpp"
+        // For Required Constants
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+static uint8_t
+CountLeadingZeros(uint64_t value)
+{
+        if (value == 0u)
+                return 64u;
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint8_t>(__builtin_clzll(value));
+#else
+        uint8_t count = 0u;
+        for (uint64_t mask = 1ull << 63u; (value & mask) == 0u; mask >>= 1u)
+                ++count;
+        return count;
+#endif
+}
+
+static uint8_t
+CountTrailingZeros(uint64_t value)
+{
+        if (value == 0u)
+                return 64u;
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint8_t>(__builtin_ctzll(value));
+#else
+        uint8_t count = 0u;
+        for (uint64_t mask = 1u; (value & mask) == 0u; mask <<= 1u)
+                ++count;
+        return count;
+#endif
+}
+
+static void
+AppendLittleEndian16(std::vector<uint8_t>& bytes, uint16_t value)
+{
+        bytes.push_back(static_cast<uint8_t>(value & 0x00FFu));
+        bytes.push_back(static_cast<uint8_t>((value & 0xFF00u) >> 8u));
+}
+
+// Compresses two-colour pixel indices with the variable code width LZW scheme of the GIF format and
+// appends the result as data sub-blocks
+static void
+AppendGifLzw(const std::vector<uint8_t>& pixels, std::vector<uint8_t>& bytes)
+{
+        const uint8_t MINIMUM_CODE_SIZE = 2u;
+        const uint16_t CLEAR_CODE = 1u << MINIMUM_CODE_SIZE;
+        const uint16_t END_OF_INFORMATION_CODE = CLEAR_CODE + 1u;
+        const uint16_t MAXIMUM_CODE = 4095u;
+        const uint8_t MAXIMUM_SUB_BLOCK_SIZE = 255u;
+
+        // Only indices 0 and 1 are ever used, so each dictionary entry needs two children
+        std::vector<std::array<uint16_t, 2>> children(MAXIMUM_CODE + 1u, std::array<uint16_t, 2>{0u, 0u});
+        std::vector<uint8_t> packed;
+        uint32_t bit_buffer = 0u;
+        uint8_t bits_in_buffer = 0u;
+        uint8_t code_size = MINIMUM_CODE_SIZE + 1u;
+        uint16_t last_code = END_OF_INFORMATION_CODE;
+
+        auto write_code = [&](uint16_t code, uint8_t size) {
+                bit_buffer |= static_cast<uint32_t>(code) << bits_in_buffer;
+                bits_in_buffer += size;
+                while (bits_in_buffer >= 8u) {
+                        packed.push_back(static_cast<uint8_t>(bit_buffer & 0xFFu));
+                        bit_buffer >>= 8u;
+                        bits_in_buffer -= 8u;
+                }
+        };
+
+        write_code(CLEAR_CODE, code_size);
+
+        uint16_t current_code = pixels.front();
+        for (size_t i = 1; i < pixels.size(); ++i) {
+                const uint8_t pixel = pixels[i];
+                if (children[current_code][pixel] != 0u) {
+                        current_code = children[current_code][pixel];
+                        continue;
+                }
+
+                write_code(current_code, code_size);
+
+                children[current_code][pixel] = ++last_code;
+                if (last_code >= (1u << code_size))
+                        ++code_size;
+
+                if (last_code == MAXIMUM_CODE) {
+                        write_code(CLEAR_CODE, code_size);
+                        std::fill(children.begin(), children.end(), std::array<uint16_t, 2>{0u, 0u});
+                        code_size = MINIMUM_CODE_SIZE + 1u;
+                        last_code = END_OF_INFORMATION_CODE;
+                }
+
+                current_code = pixel;
+        }
+
+        // The decoder adds its dictionary entries one code late, so after the final code it has
+        // caught up to the entry created by the previous one and may already read a wider code.
+        // Clearing before the end code means the decoder reads that at the minimum width.
+        write_code(current_code, code_size);
+        if (last_code + 1u >= (1u << code_size) && code_size < 12u)
+                ++code_size;
+        write_code(CLEAR_CODE, code_size);
+        write_code(END_OF_INFORMATION_CODE, MINIMUM_CODE_SIZE + 1u);
+        if (bits_in_buffer != 0u)
+                packed.push_back(static_cast<uint8_t>(bit_buffer & 0xFFu));
+
+        bytes.push_back(MINIMUM_CODE_SIZE);
+        for (size_t offset = 0; offset < packed.size(); offset += MAXIMUM_SUB_BLOCK_SIZE) {
+                const size_t sub_block_size = std::min<size_t>(MAXIMUM_SUB_BLOCK_SIZE, packed.size() - offset);
+                bytes.push_back(static_cast<uint8_t>(sub_block_size));
+                bytes.insert(bytes.end(), packed.begin() + offset, packed.begin() + offset + sub_block_size);
+        }
+        bytes.push_back(0u);
+}
+
+FrameCapture::FrameCapture(std::string_view gifFilePath, std::string_view rleFilePath, uint8_t gifScale)
+        :
+        gif_file(std::string(gifFilePath), std::ios::binary),
+        rle_file(std::string(rleFilePath), std::ios::binary),
+        gif_scale(std::max<uint8_t>(gifScale, 1u)),
+        held_frames(0u),
+        finished(false),
+        stopping(false),
+        gif_frames_encoded(0u),
+        gif_centiseconds_encoded(0u),
+        gif_frame_deferred(false),
+        gif_image_written(false)
+{
+        held_frame.fill(0u);
+        previous_gif_frame.fill(0u);
+        previous_rle_frame.fill(0u);
+        deferred_gif_frame.fill(0u);
+
+        WriteGifHeader();
+        WriteRleHeader();
+
+        encoder_thread = std::thread(&FrameCapture::EncoderLoop, this);
+}
+
+FrameCapture::~FrameCapture()
+{
+        Finish();
+}
+
+void
+FrameCapture::SubmitFrame(const Frame& frame)
+{
+        if (held_frames != 0u && frame == held_frame) {
+                ++held_frames;
+                return;
+        }
+
+        if (held_frames != 0u) {
+                {
+                        std::lock_guard<std::mutex> lock(queue_mutex);
+                        pending_frames.emplace_back(held_frame, held_frames);
+                }
+                queue_condition.notify_one();
+        }
+
+        held_frame = frame;
+        held_frames = 1u;
+}
+
+void
+FrameCapture::Finish()
+{
+        if (finished)
+                return;
+        finished = true;
+
+        {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                if (held_frames != 0u)
+                        pending_frames.emplace_back(held_frame, held_frames);
+                stopping = true;
+        }
+        queue_condition.notify_one();
+        encoder_thread.join();
+
+        // The encoder thread has exited, so its state can be used from here
+        const uint16_t MINIMUM_GIF_DELAY = 2u;
+        const uint8_t GIF_TRAILER = 0x3Bu;
+
+        if (gif_frame_deferred)
+                WriteGifImage(deferred_gif_frame, MINIMUM_GIF_DELAY);
+        gif_bytes.push_back(GIF_TRAILER);
+
+        // A hold count of zero marks the end of the RLE stream
+        WriteRleVarint(0u);
+
+        gif_file.write(reinterpret_cast<const char*>(gif_bytes.data()), gif_bytes.size());
+        rle_file.write(reinterpret_cast<const char*>(rle_bytes.data()), rle_bytes.size());
+        gif_file.close();
+        rle_file.close();
+}
+
+void
+FrameCapture::EncoderLoop()
+{
+        std::vector<HeldFrame> batch;
+
+        for (;;) {
+                {
+                        std::unique_lock<std::mutex> lock(queue_mutex);
+                        queue_condition.wait(lock, [this] { return stopping || !pending_frames.empty(); });
+                        if (pending_frames.empty())
+                                return;
+
+                        batch.swap(pending_frames);
+                }
+
+                for (const HeldFrame& held : batch) {
+                        EncodeGifFrame(held.first, held.second);
+                        EncodeRleFrame(held.first, held.second);
+                }
+                batch.clear();
+
+                gif_file.write(reinterpret_cast<const char*>(gif_bytes.data()), gif_bytes.size());
+                rle_file.write(reinterpret_cast<const char*>(rle_bytes.data()), rle_bytes.size());
+                gif_bytes.clear();
+                rle_bytes.clear();
+        }
+}
+
+void
+FrameCapture::EncodeGifFrame(const Frame& frame, uint32_t held_frames)
+{
+        const uint8_t FRAMES_PER_SECOND = 60u;
+        const uint8_t CENTISECONDS_PER_SECOND = 100u;
+        const uint16_t MINIMUM_GIF_DELAY = 2u;
+        const uint16_t MAXIMUM_GIF_DELAY = UINT16_MAX;
+
+        // Rounding the running time instead of each delay keeps the animation from drifting
+        gif_frames_encoded += held_frames;
+        const uint64_t elapsed_centiseconds =
+                (gif_frames_encoded * CENTISECONDS_PER_SECOND + FRAMES_PER_SECOND / 2u) / FRAMES_PER_SECOND;
+        uint64_t delay = elapsed_centiseconds - gif_centiseconds_encoded;
+
+        // Most viewers slow down delays below two centiseconds, so a shorter frame is folded into the
+        // next one. Images are diffed against the last written frame, so nothing is lost on screen.
+        if (delay < MINIMUM_GIF_DELAY) {
+                deferred_gif_frame = frame;
+                gif_frame_deferred = true;
+                return;
+        }
+
+        gif_centiseconds_encoded = elapsed_centiseconds;
+        gif_frame_deferred = false;
+
+        for (; delay > MAXIMUM_GIF_DELAY; delay -= MAXIMUM_GIF_DELAY)
+                WriteGifImage(frame, MAXIMUM_GIF_DELAY);
+        WriteGifImage(frame, static_cast<uint16_t>(delay));
+}
+
+void
+FrameCapture::EncodeRleFrame(const Frame& frame, uint32_t held_frames)
+{
+        const uint8_t BITS_PER_ROW = 64u;
+
+        WriteRleVarint(held_frames);
+
+        uint32_t run_length = 0u;
+        bool run_bit = false;
+
+        for (uint8_t row = 0; row < SCREEN_HEIGHT; ++row) {
+                uint64_t bits = frame[row] ^ previous_rle_frame[row];
+                uint8_t remaining_bits = BITS_PER_ROW;
+
+                while (remaining_bits != 0u) {
+                        // The leading bits that continue the current run, found a whole run at a time
+                        const uint64_t run_bits = run_bit ? ~bits : bits;
+                        const uint8_t same_bits = std::min(CountLeadingZeros(run_bits), remaining_bits);
+
+                        run_length += same_bits;
+                        remaining_bits -= same_bits;
+                        bits = same_bits == BITS_PER_ROW ? 0u : bits << same_bits;
+
+                        if (remaining_bits != 0u) {
+                                WriteRleVarint(run_length);
+                                run_length = 0u;
+                                run_bit = !run_bit;
+                        }
+                }
+        }
+
+        WriteRleVarint(run_length);
+        previous_rle_frame = frame;
+}
+
+void
+FrameCapture::WriteGifHeader()
+{
+        const uint8_t GLOBAL_COLOR_TABLE_FLAG = 0x80u;
+        const uint8_t APPLICATION_EXTENSION[] = {
+                0x21u, 0xFFu, 0x0Bu,
+                'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0',
+                0x03u, 0x01u, 0x00u, 0x00u, 0x00u       // Loop forever
+        };
+
+        const std::string_view signature = "GIF89a";
+        gif_bytes.insert(gif_bytes.end(), signature.begin(), signature.end());
+
+        AppendLittleEndian16(gif_bytes, SCREEN_WIDTH * gif_scale);
+        AppendLittleEndian16(gif_bytes, SCREEN_HEIGHT * gif_scale);
+        gif_bytes.push_back(GLOBAL_COLOR_TABLE_FLAG);   // Two entries
+        gif_bytes.push_back(0u);                        // Background colour index
+        gif_bytes.push_back(0u);                        // Pixel aspect ratio
+
+        // Unlit pixels are black and lit pixels are white
+        const uint8_t COLOR_TABLE[] = { 0x00u, 0x00u, 0x00u, 0xFFu, 0xFFu, 0xFFu };
+        gif_bytes.insert(gif_bytes.end(), std::begin(COLOR_TABLE), std::end(COLOR_TABLE));
+        gif_bytes.insert(gif_bytes.end(), std::begin(APPLICATION_EXTENSION), std::end(APPLICATION_EXTENSION));
+}
+
+void
+FrameCapture::WriteGifImage(const Frame& frame, uint16_t delay)
+{
+        const uint8_t DO_NOT_DISPOSE = 0x04u;
+        const uint8_t BITS_PER_ROW = 64u;
+
+        // Only the rectangle that changed since the last written image is stored. Its columns come
+        // straight from the OR of the changed bits of every row.
+        uint8_t top = SCREEN_HEIGHT;
+        uint8_t bottom = 0u;
+        uint64_t changed_columns = 0u;
+        for (uint8_t row = 0; row < SCREEN_HEIGHT; ++row) {
+                const uint64_t changed_bits = frame[row] ^ previous_gif_frame[row];
+                if (changed_bits == 0u)
+                        continue;
+
+                top = std::min(top, row);
+                bottom = row;
+                changed_columns |= changed_bits;
+        }
+
+        // The first image has to cover the whole canvas, which viewers otherwise leave transparent.
+        // Every later image has to cover at least one pixel.
+        uint8_t left = 0u;
+        uint8_t right = 0u;
+        if (!gif_image_written) {
+                top = 0u;
+                bottom = SCREEN_HEIGHT - 1u;
+                right = BITS_PER_ROW - 1u;
+        } else if (changed_columns == 0u) {
+                top = 0u;
+                bottom = 0u;
+        } else {
+                left = CountLeadingZeros(changed_columns);
+                right = BITS_PER_ROW - 1u - CountTrailingZeros(changed_columns);
+        }
+
+        const uint16_t width = (right - left + 1u) * gif_scale;
+        const uint16_t height = (bottom - top + 1u) * gif_scale;
+
+        // Graphic control extension
+        gif_bytes.insert(gif_bytes.end(), { 0x21u, 0xF9u, 0x04u, DO_NOT_DISPOSE });
+        AppendLittleEndian16(gif_bytes, delay);
+        gif_bytes.insert(gif_bytes.end(), { 0x00u, 0x00u });
+
+        // Image descriptor
+        gif_bytes.push_back(0x2Cu);
+        AppendLittleEndian16(gif_bytes, left * gif_scale);
+        AppendLittleEndian16(gif_bytes, top * gif_scale);
+        AppendLittleEndian16(gif_bytes, width);
+        AppendLittleEndian16(gif_bytes, height);
+        gif_bytes.push_back(0x00u);
+
+        std::vector<uint8_t> pixels;
+        pixels.reserve(static_cast<size_t>(width) * height);
+        for (uint8_t row = top; row <= bottom; ++row)
+                for (uint8_t repeat_row = 0; repeat_row < gif_scale; ++repeat_row)
+                        for (uint8_t column = left; column <= right; ++column)
+                                pixels.insert(pixels.end(), gif_scale,
+                                              static_cast<uint8_t>((frame[row] >> (BITS_PER_ROW - 1u - column)) & 1u));
+
+        AppendGifLzw(pixels, gif_bytes);
+        previous_gif_frame = frame;
+        gif_image_written = true;
+}
+
+void
+FrameCapture::WriteRleHeader()
+{
+        const uint8_t VERSION = 1u;
+
+        const std::string_view magic = "BSRL";
+        rle_bytes.insert(rle_bytes.end(), magic.begin(), magic.end());
+        rle_bytes.push_back(VERSION);
+        rle_bytes.push_back(SCREEN_WIDTH);
+        rle_bytes.push_back(SCREEN_HEIGHT);
+}
+
+void
+FrameCapture::WriteRleVarint(uint32_t value)
+{
+        // Seven bits per byte, least significant group first, high bit set on all but the last byte
+        while (value >= 0x80u) {
+                rle_bytes.push_back(static_cast<uint8_t>((value & 0x7Fu) | 0x80u));
+                value >>= 7u;
+        }
+        rle_bytes.push_back(static_cast<uint8_t>(value));
+}
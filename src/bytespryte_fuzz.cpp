@@ -0,0 +1,122 @@
+#include "Chip8Fuzzer.hpp"
+        // For the fuzzing engine
+#include "Constants.hpp"
+        // For Required Constants
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Usage: bytespryte_fuzz [-j workers] [-t seconds] [-c cycles] [seed.ch8 ...]
+//        bytespryte_fuzz [-c cycles] -r finding.ch8 finding.keys
+//
+// Every finding is written next to the working directory as finding_<n>_<kind>.ch8 together with a
+// finding_<n>_<kind>.keys file holding its keypad states as little-endian 16-bit values. Passing
+// both files to -r executes that test case once and reports the fault it hits.
+
+static bool
+ReadFile(const char* path, std::vector<uint8_t>& contents)
+{
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+                std::fprintf(stderr, "Could not open %s\n", path);
+                return false;
+        }
+
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+}
+
+static int
+Replay(const char* rom_path, const char* keys_path, uint32_t cycles_per_execution)
+{
+        Chip8Fuzzer::TestCase test_case;
+        std::vector<uint8_t> keys;
+        if (!ReadFile(rom_path, test_case.rom) || !ReadFile(keys_path, keys))
+                return EXIT_FAILURE;
+
+        test_case.rom.resize(std::min<size_t>(test_case.rom.size(), MEMORY_SIZE - MEMORY_START_ADDRESS));
+        for (size_t i = 0; i + 1 < keys.size(); i += 2)
+                test_case.keypad_states.push_back(static_cast<uint16_t>(keys[i] | (keys[i + 1] << 8u)));
+
+        Chip8Fuzzer fuzzer({}, cycles_per_execution);
+        const Chip8Fuzzer::Finding finding = fuzzer.Execute(test_case);
+
+        if (finding.kind == Chip8Fuzzer::FaultKind::None) {
+                std::printf("No fault in %u cycles\n", cycles_per_execution);
+                return EXIT_SUCCESS;
+        }
+
+        std::printf("%s at 0x%03X (instruction 0x%04X)\n",
+                    Chip8Fuzzer::FaultKindName(finding.kind), finding.address, finding.instruction);
+        return EXIT_FAILURE;
+}
+
+int
+main(int argc, char** argv)
+{
+        unsigned worker_count = std::thread::hardware_concurrency();
+        uint32_t seconds = 60u;
+        uint32_t cycles_per_execution = 256u;
+        std::vector<Chip8Fuzzer::TestCase> seeds;
+        const char* replay_rom_path = nullptr;
+        const char* replay_keys_path = nullptr;
+
+        for (int i = 1; i < argc; ++i) {
+                if (std::strcmp(argv[i], "-r") == 0 && i + 2 < argc) {
+                        replay_rom_path = argv[++i];
+                        replay_keys_path = argv[++i];
+                } else if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+                        worker_count = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+                } else if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+                        seconds = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+                } else if (std::strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+                        cycles_per_execution = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+                } else {
+                        Chip8Fuzzer::TestCase seed;
+                        if (!ReadFile(argv[i], seed.rom))
+                                return EXIT_FAILURE;
+
+                        seed.rom.resize(std::min<size_t>(seed.rom.size(), MEMORY_SIZE - MEMORY_START_ADDRESS));
+                        seeds.push_back(seed);
+                }
+        }
+
+        if (replay_rom_path != nullptr)
+                return Replay(replay_rom_path, replay_keys_path, cycles_per_execution);
+
+        Chip8Fuzzer fuzzer(seeds, cycles_per_execution);
+        fuzzer.Run(worker_count, std::chrono::seconds(seconds));
+
+        const std::vector<Chip8Fuzzer::Finding> findings = fuzzer.GetFindings();
+        for (size_t i = 0; i < findings.size(); ++i) {
+                const Chip8Fuzzer::Finding& finding = findings[i];
+                const std::string name = "finding_" + std::to_string(i) + "_" + Chip8Fuzzer::FaultKindName(finding.kind);
+
+                std::printf("%s at 0x%03X (instruction 0x%04X)\n", name.c_str(), finding.address, finding.instruction);
+
+                std::ofstream rom_file(name + ".ch8", std::ios::binary);
+                rom_file.write(reinterpret_cast<const char*>(finding.test_case.rom.data()), finding.test_case.rom.size());
+
+                std::ofstream keys_file(name + ".keys", std::ios::binary);
+                for (const uint16_t keypad : finding.test_case.keypad_states) {
+                        const char bytes[] = { static_cast<char>(keypad & 0x00FFu), static_cast<char>((keypad & 0xFF00u) >> 8u) };
+                        keys_file.write(bytes, sizeof(bytes));
+                }
+        }
+
+        std::printf("%llu executions (%.0f per second) on %u workers, %u edges, corpus of %zu, %zu findings\n",
+                    static_cast<unsigned long long>(fuzzer.GetExecutions()),
+                    seconds == 0u ? 0.0 : static_cast<double>(fuzzer.GetExecutions()) / seconds,
+                    worker_count, fuzzer.GetCoveredEdges(), fuzzer.GetCorpusSize(), findings.size());
+
+        return findings.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}